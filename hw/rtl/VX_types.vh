@@ -120,6 +120,11 @@
 `define VX_CSR_MPM_SCRB_OM_H            12'hB94
 `define VX_CSR_MPM_SCRB_RASTER          12'hB15
 `define VX_CSR_MPM_SCRB_RASTER_H        12'hB95
+// SIM: decoded instruction cache
+`define VX_CSR_MPM_DECODE_HITS          12'hB16
+`define VX_CSR_MPM_DECODE_HITS_H        12'hB96
+`define VX_CSR_MPM_DECODE_MISSES        12'hB17
+`define VX_CSR_MPM_DECODE_MISSES_H      12'hB97
 
 // Machine Performance-monitoring memory counters
 // PERF: icache
@@ -0,0 +1,229 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// SimPlatform event scheduler microbenchmark.
+// Runs the same synthetic packet workload through the legacy list-scan
+// scheduler (reproduced below) and through SimPlatform's timing wheel,
+// reports events/sec for both and checks that delivery order matches.
+
+#include <iostream>
+#include <chrono>
+#include <list>
+#include <queue>
+#include <vector>
+#include <unistd.h>
+#include <stdlib.h>
+#include <simobject.h>
+
+static uint32_t num_nodes  = 64;
+static uint32_t num_pkts   = 16;
+static uint32_t max_delay  = 64;
+static uint32_t num_cycles = 20000;
+
+static void show_usage() {
+  std::cout << "Usage: [-n <nodes>] [-p <packets/node/cycle>] [-d <max delay>] [-c <cycles>] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "n:p:d:c:h?")) != -1) {
+    switch (c) {
+    case 'n': num_nodes = atoi(optarg); break;
+    case 'p': num_pkts = atoi(optarg); break;
+    case 'd': max_delay = atoi(optarg); break;
+    case 'c': num_cycles = atoi(optarg); break;
+    case 'h':
+    case '?':
+      show_usage();
+      exit(0);
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// deterministic traffic generator shared by both schedulers
+class Traffic {
+public:
+  Traffic() : seed_(0x12345678), next_id_(0), hash_(0), received_(0) {}
+
+  template <typename F>
+  void produce(uint32_t node, const F& send) {
+    for (uint32_t i = 0; i < num_pkts; ++i) {
+      uint32_t r = this->rand();
+      uint32_t dst = (node + r) % num_nodes;
+      uint64_t delay = 1 + (r >> 8) % max_delay;
+      if ((r & 0xff) == 0) {
+        delay += 1000; // occasional long-latency request
+      }
+      send(dst, next_id_++, delay);
+    }
+  }
+
+  void consume(uint64_t id) {
+    hash_ = (hash_ ^ id) * 0x100000001b3ull;
+    ++received_;
+  }
+
+  uint64_t hash() const { return hash_; }
+  uint64_t received() const { return received_; }
+
+private:
+  uint32_t rand() {
+    seed_ = seed_ * 1664525 + 1013904223;
+    return seed_;
+  }
+
+  uint32_t seed_;
+  uint64_t next_id_;
+  uint64_t hash_;
+  uint64_t received_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// legacy scheduler: a shared_ptr event list scanned in full every cycle
+class LegacyBench {
+public:
+  void run(Traffic& traffic) {
+    std::vector<std::queue<uint64_t>> inputs(num_nodes);
+    cycles_ = 0;
+    for (uint32_t c = 0; c < num_cycles; ++c) {
+      // evaluate events
+      auto it = events_.begin();
+      while (it != events_.end()) {
+        auto& evt = *it;
+        if (cycles_ >= evt->cycles) {
+          inputs.at(evt->dst).push(evt->id);
+          it = events_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      // evaluate nodes
+      for (uint32_t n = 0; n < num_nodes; ++n) {
+        auto& input = inputs.at(n);
+        while (!input.empty()) {
+          traffic.consume(input.front());
+          input.pop();
+        }
+        traffic.produce(n, [&](uint32_t dst, uint64_t id, uint64_t delay) {
+          events_.emplace_back(std::make_shared<event_t>(event_t{dst, id, cycles_ + delay}));
+        });
+      }
+      ++cycles_;
+    }
+    events_.clear();
+  }
+
+private:
+  struct event_t {
+    uint32_t dst;
+    uint64_t id;
+    uint64_t cycles;
+  };
+  std::list<std::shared_ptr<event_t>> events_;
+  uint64_t cycles_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Node : public SimObject<Node> {
+public:
+  SimPort<uint64_t> Input;
+
+  Node(const SimContext& ctx, uint32_t id, Traffic* traffic, std::vector<Node*>* nodes)
+    : SimObject<Node>(ctx, "node")
+    , Input(this)
+    , id_(id)
+    , traffic_(traffic)
+    , nodes_(nodes)
+  {}
+
+  void reset() {}
+
+  void tick() {
+    while (!Input.empty()) {
+      traffic_->consume(Input.front());
+      Input.pop();
+    }
+    traffic_->produce(id_, [&](uint32_t dst, uint64_t id, uint64_t delay) {
+      nodes_->at(dst)->Input.push(id, delay);
+    });
+  }
+
+private:
+  uint32_t id_;
+  Traffic* traffic_;
+  std::vector<Node*>* nodes_;
+};
+
+static void run_platform(Traffic& traffic) {
+  std::vector<Node*> nodes(num_nodes);
+  std::vector<Node::Ptr> refs;
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    auto node = Node::Create(n, &traffic, &nodes);
+    nodes.at(n) = node.get();
+    refs.push_back(node);
+  }
+  SimPlatform::instance().reset();
+  for (uint32_t c = 0; c < num_cycles; ++c) {
+    SimPlatform::instance().tick();
+  }
+  SimPlatform::instance().finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename F>
+static double measure(Traffic& traffic, const F& func) {
+  auto start = std::chrono::high_resolution_clock::now();
+  func(traffic);
+  auto end = std::chrono::high_resolution_clock::now();
+  double secs = std::chrono::duration<double>(end - start).count();
+  return traffic.received() / secs;
+}
+
+int main(int argc, char **argv) {
+  parse_args(argc, argv);
+
+  std::cout << "nodes=" << num_nodes
+            << ", packets/node/cycle=" << num_pkts
+            << ", max_delay=" << max_delay
+            << ", cycles=" << num_cycles << std::endl;
+
+  Traffic legacy_traffic;
+  LegacyBench legacy;
+  double legacy_rate = measure(legacy_traffic, [&](Traffic& t) { legacy.run(t); });
+
+  Traffic wheel_traffic;
+  double wheel_rate = measure(wheel_traffic, run_platform);
+
+  std::cout << "legacy list:  " << legacy_traffic.received() << " events, "
+            << uint64_t(legacy_rate) << " events/sec" << std::endl;
+  std::cout << "timing wheel: " << wheel_traffic.received() << " events, "
+            << uint64_t(wheel_rate) << " events/sec" << std::endl;
+  std::cout << "speedup: " << (wheel_rate / legacy_rate) << "x" << std::endl;
+
+  if (legacy_traffic.received() != wheel_traffic.received()
+   || legacy_traffic.hash() != wheel_traffic.hash()) {
+    std::cout << "Error: event delivery order mismatch!" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+  return 0;
+}
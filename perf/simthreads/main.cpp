@@ -0,0 +1,259 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// SimPlatform parallel ticking scaling benchmark.
+// Builds a synthetic system of clusters (one partition each) whose nodes
+// compute and exchange packets locally, remotely and through a shared hub,
+// then runs it with 1, 2, 4, ... host threads. Reports the wall time and
+// speedup of each run and checks that cycle counts and packet delivery
+// order are identical to the serial engine.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <stdlib.h>
+#include <simobject.h>
+
+static uint32_t num_clusters = 16;
+static uint32_t num_nodes    = 8;
+static uint32_t num_pkts     = 2000;
+static uint32_t work_size    = 2000;
+static uint32_t max_threads  = 0;
+
+static void show_usage() {
+  std::cout << "Usage: [-k <clusters>] [-n <nodes/cluster>] [-p <packets/node>] [-w <work/tick>] [-t <max threads>] [-h: help]" << std::endl;
+}
+
+static void parse_args(int argc, char **argv) {
+  int c;
+  while ((c = getopt(argc, argv, "k:n:p:w:t:h?")) != -1) {
+    switch (c) {
+    case 'k': num_clusters = atoi(optarg); break;
+    case 'n': num_nodes = atoi(optarg); break;
+    case 'p': num_pkts = atoi(optarg); break;
+    case 'w': work_size = atoi(optarg); break;
+    case 't': max_threads = atoi(optarg); break;
+    case 'h':
+    case '?':
+      show_usage();
+      exit(0);
+    default:
+      show_usage();
+      exit(-1);
+    }
+  }
+  if (max_threads == 0) {
+    max_threads = std::thread::hardware_concurrency();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Packet {
+  uint32_t dst;
+  uint64_t id;
+};
+
+class Node;
+
+class Hub : public SimObject<Hub> {
+public:
+  SimPort<Packet> Input;
+
+  Hub(const SimContext& ctx, std::vector<Node*>* nodes)
+    : SimObject<Hub>(ctx, "hub")
+    , Input(this)
+    , nodes_(nodes)
+  {}
+
+  void reset() {}
+
+  void tick();
+
+private:
+  std::vector<Node*>* nodes_;
+};
+
+class Node : public SimObject<Node> {
+public:
+  SimPort<Packet> Input;
+
+  Node(const SimContext& ctx, uint32_t id, Hub* hub, std::vector<Node*>* nodes)
+    : SimObject<Node>(ctx, "node")
+    , Input(this)
+    , id_(id)
+    , seed_(0x12345678 + id)
+    , sent_(0)
+    , received_(0)
+    , hash_(0)
+    , hub_(hub)
+    , nodes_(nodes)
+  {}
+
+  void reset() {}
+
+  void tick() {
+    while (!Input.empty()) {
+      hash_ = (hash_ ^ Input.front().id) * 0x100000001b3ull;
+      ++received_;
+      Input.pop();
+    }
+
+    // model per-cycle compute
+    uint32_t r = 0;
+    for (uint32_t i = 0; i < work_size; ++i) {
+      r = this->rand();
+    }
+
+    if (sent_ == num_pkts || (r & 0x3) != 0)
+      return;
+
+    uint32_t cluster = id_ / num_nodes;
+    uint64_t pkt_id = (uint64_t(id_) << 32) | sent_++;
+    uint64_t delay = 1 + ((r >> 8) & 0x7);
+    switch ((r >> 4) & 0x3) {
+    case 0: {
+      // remote node
+      uint32_t dst = (r >> 12) % nodes_->size();
+      nodes_->at(dst)->Input.push({dst, pkt_id}, delay);
+    } break;
+    case 1: {
+      // through the hub
+      uint32_t dst = (r >> 12) % nodes_->size();
+      hub_->Input.push({dst, pkt_id}, delay);
+    } break;
+    default: {
+      // local node
+      uint32_t dst = cluster * num_nodes + (r >> 12) % num_nodes;
+      nodes_->at(dst)->Input.push({dst, pkt_id}, delay);
+    } break;
+    }
+  }
+
+  uint64_t sent() const { return sent_; }
+  uint64_t received() const { return received_; }
+  uint64_t hash() const { return hash_; }
+
+private:
+  uint32_t rand() {
+    seed_ = seed_ * 1664525 + 1013904223;
+    return seed_;
+  }
+
+  uint32_t id_;
+  uint32_t seed_;
+  uint64_t sent_;
+  uint64_t received_;
+  uint64_t hash_;
+  Hub* hub_;
+  std::vector<Node*>* nodes_;
+};
+
+void Hub::tick() {
+  while (!Input.empty()) {
+    auto& pkt = Input.front();
+    nodes_->at(pkt.dst)->Input.push(pkt, 2);
+    Input.pop();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct result_t {
+  uint64_t cycles;
+  uint64_t hash;
+  double   secs;
+};
+
+static result_t run_platform(uint32_t num_threads) {
+  auto& platform = SimPlatform::instance();
+  std::vector<Node*> nodes(num_clusters * num_nodes);
+  std::vector<Node::Ptr> refs;
+  auto hub = Hub::Create(&nodes);
+  for (uint32_t k = 0; k < num_clusters; ++k) {
+    platform.set_partition(k + 1);
+    for (uint32_t n = 0; n < num_nodes; ++n) {
+      uint32_t id = k * num_nodes + n;
+      auto node = Node::Create(id, hub.get(), &nodes);
+      nodes.at(id) = node.get();
+      refs.push_back(node);
+    }
+  }
+  platform.set_partition(0);
+  platform.set_num_threads(num_threads);
+  platform.reset();
+
+  uint64_t total_pkts = uint64_t(num_pkts) * nodes.size();
+  auto start = std::chrono::high_resolution_clock::now();
+  for (;;) {
+    platform.tick();
+    uint64_t received = 0;
+    for (auto node : nodes) {
+      received += node->received();
+    }
+    if (received == total_pkts)
+      break;
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  result_t result;
+  result.cycles = platform.cycles();
+  result.hash = 0;
+  for (auto node : nodes) {
+    result.hash = (result.hash ^ node->hash()) * 0x100000001b3ull;
+  }
+  result.secs = std::chrono::duration<double>(end - start).count();
+  platform.finalize();
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char **argv) {
+  parse_args(argc, argv);
+
+  std::cout << "clusters=" << num_clusters
+            << ", nodes/cluster=" << num_nodes
+            << ", packets/node=" << num_pkts
+            << ", work/tick=" << work_size
+            << ", max_threads=" << max_threads << std::endl;
+
+  bool passed = true;
+  result_t serial{0, 0, 0};
+  for (uint32_t t = 1; t <= max_threads; t *= 2) {
+    auto result = run_platform(t);
+    if (t == 1) {
+      serial = result;
+    }
+    bool match = (result.cycles == serial.cycles && result.hash == serial.hash);
+    passed &= match;
+    std::cout << "threads=" << std::setw(3) << t
+              << ", cycles=" << result.cycles
+              << ", time=" << std::fixed << std::setprecision(3) << result.secs << "s"
+              << ", speedup=" << std::setprecision(2) << (serial.secs / result.secs) << "x"
+              << (match ? "" : " (MISMATCH)") << std::endl;
+    if (num_clusters < t * 2)
+      break;
+  }
+
+  if (!passed) {
+    std::cout << "Error: parallel run differs from the serial engine!" << std::endl;
+    return -1;
+  }
+
+  std::cout << "PASSED!" << std::endl;
+  return 0;
+}
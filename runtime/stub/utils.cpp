@@ -196,6 +196,8 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
   uint64_t stores = 0;
   uint64_t ifetch_lat = 0;
   uint64_t load_lat   = 0;
+  uint64_t decode_hits = 0;
+  uint64_t decode_misses = 0;
   // PERF: l2cache
   uint64_t l2cache_reads = 0;
   uint64_t l2cache_writes = 0;
@@ -436,6 +438,23 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
         if (num_cores > 1) fprintf(stream, "PERF: core%d: stores=%ld\n", core_id, stores_per_core);
         stores += stores_per_core;
       }
+      // decode cache (simulator only)
+      {
+        uint64_t decode_hits_per_core;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_DECODE_HITS, core_id, &decode_hits_per_core), {
+          return err;
+        });
+        uint64_t decode_misses_per_core;
+        CHECK_ERR(vx_mpm_query(hdevice, VX_CSR_MPM_DECODE_MISSES, core_id, &decode_misses_per_core), {
+          return err;
+        });
+        if (num_cores > 1 && (decode_hits_per_core + decode_misses_per_core) != 0) {
+          int hit_ratio = calcRatio(decode_misses_per_core, decode_hits_per_core + decode_misses_per_core);
+          fprintf(stream, "PERF: core%d: decode cache hits=%ld, misses=%ld (hit ratio=%d%%)\n", core_id, decode_hits_per_core, decode_misses_per_core, hit_ratio);
+        }
+        decode_hits += decode_hits_per_core;
+        decode_misses += decode_misses_per_core;
+      }
     } break;
     case VX_DCR_MPM_CLASS_MEM: {
       if (lmem_enable) {
@@ -686,6 +705,10 @@ extern int vx_dump_perf(vx_device_h hdevice, FILE* stream) {
     fprintf(stream, "PERF: stores=%ld\n", stores);
     fprintf(stream, "PERF: ifetch latency=%d cycles\n", ifetch_avg_lat);
     fprintf(stream, "PERF: load latency=%d cycles\n", load_avg_lat);
+    if ((decode_hits + decode_misses) != 0) {
+      int decode_hit_ratio = calcRatio(decode_misses, decode_hits + decode_misses);
+      fprintf(stream, "PERF: decode cache hits=%ld, misses=%ld (hit ratio=%d%%)\n", decode_hits, decode_misses, decode_hit_ratio);
+    }
   } break;
   case VX_DCR_MPM_CLASS_MEM: {
     if (l2cache_enable) {
@@ -270,7 +270,8 @@ RAM::RAM(uint64_t capacity, uint32_t page_size)
   , page_bits_(log2ceil(page_size))
   , last_page_(nullptr)
   , last_page_index_(0)
-  , check_acl_(false) {
+  , check_acl_(false)
+  , code_version_(1) {
   assert(ispow2(page_size));
   if (capacity != 0) {
     assert(ispow2(capacity));
@@ -284,9 +285,16 @@ RAM::~RAM() {
 }
 
 void RAM::clear() {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   for (auto& page : pages_) {
     delete[] page.second;
   }
+  pages_.clear();
+  last_page_ = nullptr;
+  if (!code_pages_.empty()) {
+    code_pages_.clear();
+    ++code_version_;
+  }
 }
 
 uint64_t RAM::size() const {
@@ -325,6 +333,7 @@ uint8_t *RAM::get(uint64_t address) const {
 }
 
 void RAM::read(void* data, uint64_t addr, uint64_t size) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   if (check_acl_ && acl_mngr_.check(addr, size, 0x1) == false) {
     throw BadAddress();
   }
@@ -335,9 +344,11 @@ void RAM::read(void* data, uint64_t addr, uint64_t size) {
 }
 
 void RAM::write(const void* data, uint64_t addr, uint64_t size) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   if (check_acl_ && acl_mngr_.check(addr, size, 0x2) == false) {
     throw BadAddress();
   }
+  this->invalidate_code(addr, size);
   const uint8_t* d = (const uint8_t*)data;
   for (uint64_t i = 0; i < size; i++) {
     *this->get(addr + i) = d[i];
@@ -345,12 +356,44 @@ void RAM::write(const void* data, uint64_t addr, uint64_t size) {
 }
 
 void RAM::set_acl(uint64_t addr, uint64_t size, int flags) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   if (capacity_ != 0 && (addr + size)> capacity_) {
     throw OutOfRange();
   }
+  this->invalidate_code(addr, size);
   acl_mngr_.set(addr, size, flags);
 }
 
+void RAM::mark_code(uint64_t addr) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  code_pages_.insert(addr >> page_bits_);
+}
+
+void RAM::invalidate_code(uint64_t addr, uint64_t size) {
+  if (code_pages_.empty() || size == 0)
+    return;
+  uint64_t first = addr >> page_bits_;
+  uint64_t last  = (addr + size - 1) >> page_bits_;
+  bool modified = false;
+  if ((last - first) < code_pages_.size()) {
+    for (uint64_t page = first; page <= last; ++page) {
+      modified |= (code_pages_.erase(page) != 0);
+    }
+  } else {
+    for (auto it = code_pages_.begin(); it != code_pages_.end();) {
+      if (*it >= first && *it <= last) {
+        it = code_pages_.erase(it);
+        modified = true;
+      } else {
+        ++it;
+      }
+    }
+  }
+  if (modified) {
+    ++code_version_;
+  }
+}
+
 void RAM::loadBinImage(const char* filename, uint64_t destination) {
   std::ifstream ifs(filename);
   if (!ifs) {
@@ -17,6 +17,9 @@
 #include <vector>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+#include <mutex>
 #include <cstdint>
 
 namespace vortex {
@@ -206,10 +209,30 @@ public:
     check_acl_ = enable;
   }
 
+  // flag the page holding addr as containing decoded code;
+  // any later write to that page bumps code_version().
+  void mark_code(uint64_t addr);
+
+  uint64_t code_version() const {
+    return code_version_.load(std::memory_order_acquire);
+  }
+
+  // read()/write() are serialized internally; hold the lock across several
+  // accesses that must appear atomic to other host threads (e.g. AMOs).
+  void lock() {
+    mutex_.lock();
+  }
+
+  void unlock() {
+    mutex_.unlock();
+  }
+
 private:
 
   uint8_t *get(uint64_t address) const;
 
+  void invalidate_code(uint64_t addr, uint64_t size);
+
   uint64_t capacity_;
   uint32_t page_bits_;
   mutable std::unordered_map<uint64_t, uint8_t*> pages_;
@@ -217,6 +240,9 @@ private:
   mutable uint64_t last_page_index_;
   ACLManager acl_mngr_;
   bool check_acl_;
+  std::unordered_set<uint64_t> code_pages_;
+  std::atomic<uint64_t> code_version_;
+  std::recursive_mutex mutex_;
 };
 
 } // namespace vortex
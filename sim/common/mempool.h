@@ -13,50 +13,89 @@
 
 #pragma once
 
-#include <stack>
+#include <vector>
+#include <atomic>
+#include <stdint.h>
 
+// Fixed-size object allocator backed by slabs of 'block_size' entries.
+// Released entries are threaded onto an intrusive free list and recycled;
+// slabs are only returned to the system on flush() or destruction.
+// allocate()/deallocate() are guarded by a spin lock so that pools can be
+// shared by simulation objects ticked on different host threads.
 template <typename T>
 class MemoryPool {
-public:  
-  MemoryPool(uint32_t max_size) : max_size_(max_size) {}
+public:
+  MemoryPool(uint32_t block_size)
+    : free_list_(nullptr)
+    , block_size_(block_size ? block_size : 1) {
+    lock_.clear();
+  }
 
-  MemoryPool(MemoryPool && other) 
-    : free_list_(std::move(other.free_list_)) 
-  {}
+  MemoryPool(MemoryPool && other)
+    : slabs_(std::move(other.slabs_))
+    , free_list_(other.free_list_)
+    , block_size_(other.block_size_) {
+    lock_.clear();
+    other.free_list_ = nullptr;
+  }
 
   ~MemoryPool() {
     this->flush();
   }
 
   void* allocate() {
-    void* mem;
-    if (!free_list_.empty()) {
-      auto entry = free_list_.top();
-      free_list_.pop();
-      mem = static_cast<void*>(entry);      
-    } else {
-      mem = ::operator new(sizeof(T));
+    this->lock();
+    if (nullptr == free_list_) {
+      this->grow();
     }
-    return mem;
+    auto entry = free_list_;
+    free_list_ = entry->next;
+    this->unlock();
+    return static_cast<void*>(entry);
   }
 
   void deallocate(void * object) {
-    if (free_list_.size() < max_size_) {
-      free_list_.push(static_cast<T*>(object));
-    } else {
-      ::operator delete(object);
-    }
+    auto entry = static_cast<entry_t*>(object);
+    this->lock();
+    entry->next = free_list_;
+    free_list_ = entry;
+    this->unlock();
   }
 
   void flush() {
-    while (!free_list_.empty()) {
-      auto entry = free_list_.top();
-      free_list_.pop();
-      ::operator delete(entry);      
+    for (auto slab : slabs_) {
+      ::operator delete(slab);
     }
+    slabs_.clear();
+    free_list_ = nullptr;
   }
 
 private:
-  std::stack<T*> free_list_;
-  uint32_t max_size_;
+
+  union entry_t {
+    entry_t* next;
+    alignas(T) char storage[sizeof(T)];
+  };
+
+  void lock() {
+    while (lock_.test_and_set(std::memory_order_acquire)) {}
+  }
+
+  void unlock() {
+    lock_.clear(std::memory_order_release);
+  }
+
+  void grow() {
+    auto slab = static_cast<entry_t*>(::operator new(sizeof(entry_t) * block_size_));
+    for (uint32_t i = 0; i < block_size_; ++i) {
+      slab[i].next = (i + 1 < block_size_) ? &slab[i + 1] : free_list_;
+    }
+    free_list_ = slab;
+    slabs_.push_back(slab);
+  }
+
+  std::vector<entry_t*> slabs_;
+  entry_t* free_list_;
+  uint32_t block_size_;
+  std::atomic_flag lock_;
 };
@@ -21,6 +21,7 @@
 #include <queue>
 #include <assert.h>
 #include "mempool.h"
+#include "thread_pool.h"
 
 class SimObjectBase;
 
@@ -134,8 +135,6 @@ protected:
 
 class SimEventBase {
 public:
-  typedef std::shared_ptr<SimEventBase> Ptr;
-
   virtual ~SimEventBase() {}
   
   virtual void fire() const = 0;
@@ -145,9 +144,134 @@ public:
   }
 
 protected:
-  SimEventBase(uint64_t cycles) : cycles_(cycles) {}
+  SimEventBase(uint64_t cycles) 
+    : cycles_(cycles)
+    , next_(nullptr) 
+  {}
 
   uint64_t cycles_;
+
+private:
+  SimEventBase* next_;
+
+  friend class SimEventQueue;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Timing wheel of per-cycle event buckets.
+// Events due within the wheel window are appended to the bucket of their 
+// target cycle; longer delays are parked in an overflow heap and moved onto 
+// the wheel once they enter the window, which preserves the insertion order 
+// of events that are due on the same cycle.
+class SimEventQueue {
+public:
+  SimEventQueue(uint32_t log_buckets = 8)
+    : buckets_(1 << log_buckets, {nullptr, nullptr})
+    , mask_((1 << log_buckets) - 1)
+    , size_(0)
+    , seq_(0)
+  {}
+
+  ~SimEventQueue() {
+    this->clear();
+  }
+
+  bool empty() const {
+    return (0 == size_);
+  }
+
+  uint64_t size() const {
+    return size_;
+  }
+
+  void push(SimEventBase* evt, uint64_t cycles) {
+    assert(evt->cycles() > cycles);
+    if ((evt->cycles() - cycles) <= mask_) {
+      this->append(evt);
+    } else {
+      overflow_.push({evt->cycles(), seq_++, evt});
+    }
+    ++size_;
+  }
+
+  // fire all events due at 'cycles'
+  // must be called once for every consecutive cycle
+  void fire(uint64_t cycles) {
+    while (!overflow_.empty()
+        && (overflow_.top().cycles - cycles) <= mask_) {
+      this->append(overflow_.top().evt);
+      overflow_.pop();
+    }
+    auto& bucket = buckets_[cycles & mask_];
+    auto evt = bucket.head;
+    bucket.head = nullptr;
+    bucket.tail = nullptr;
+    while (evt) {
+      assert(evt->cycles() == cycles);
+      auto next = evt->next_;
+      evt->fire();
+      delete evt;
+      --size_;
+      evt = next;
+    }
+  }
+
+  void clear() {
+    for (auto& bucket : buckets_) {
+      auto evt = bucket.head;
+      while (evt) {
+        auto next = evt->next_;
+        delete evt;
+        evt = next;
+      }
+      bucket.head = nullptr;
+      bucket.tail = nullptr;
+    }
+    while (!overflow_.empty()) {
+      delete overflow_.top().evt;
+      overflow_.pop();
+    }
+    size_ = 0;
+    seq_ = 0;
+  }
+
+private:
+
+  struct bucket_t {
+    SimEventBase* head;
+    SimEventBase* tail;
+  };
+
+  struct overflow_entry_t {
+    uint64_t      cycles;
+    uint64_t      seq;
+    SimEventBase* evt;
+
+    bool operator>(const overflow_entry_t& other) const {
+      return (cycles > other.cycles) 
+          || (cycles == other.cycles && seq > other.seq);
+    }
+  };
+
+  void append(SimEventBase* evt) {
+    auto& bucket = buckets_[evt->cycles() & mask_];
+    evt->next_ = nullptr;
+    if (bucket.tail) {
+      bucket.tail->next_ = evt;
+    } else {
+      bucket.head = evt;
+    }
+    bucket.tail = evt;
+  }
+
+  std::vector<bucket_t> buckets_;
+  std::priority_queue<overflow_entry_t, 
+                      std::vector<overflow_entry_t>, 
+                      std::greater<overflow_entry_t>> overflow_;
+  uint64_t mask_;
+  uint64_t size_;
+  uint64_t seq_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -243,6 +367,7 @@ private:
   virtual void do_tick() = 0;
 
   std::string name_;
+  uint32_t    partition_;
 
   friend class SimPlatform;
 };
@@ -307,15 +432,36 @@ public:
     instance().clear();
   }
 
+  // Objects created while a non-zero partition is set are ticked as one unit,
+  // possibly on a worker thread when parallel ticking is enabled.
+  // Partitions must not interact within a cycle other than through SimPorts.
+  void set_partition(uint32_t partition) {
+    partition_ = partition;
+  }
+
+  // Tick partitions concurrently on up to num_threads host threads (1 = serial).
+  // Port traffic produced by a partition is buffered and merged at the end
+  // of the cycle in creation order, so timing matches the serial engine.
+  void set_num_threads(uint32_t num_threads) {
+    workers_.reset();
+    if (num_threads > 1) {
+      workers_.reset(new ThreadPool(num_threads));
+    }
+    stages_.clear();
+  }
+
   template <typename Impl, typename... Args>
   typename SimObject<Impl>::Ptr create_object(Args&&... args) {
     auto obj = std::make_shared<Impl>(SimContext{}, std::forward<Args>(args)...);
+    obj->partition_ = partition_;
     objects_.push_back(obj);
+    stages_.clear();
     return obj;
   }
 
   void release_object(const SimObjectBase::Ptr& object) {
     objects_.remove(object);
+    stages_.clear();
   }
 
   template <typename Pkt>
@@ -323,8 +469,8 @@ public:
                 const Pkt& pkt, 
                 uint64_t delay) {    
     assert(delay != 0);
-    auto evt = std::make_shared<SimCallEvent<Pkt>>(callback, pkt, cycles_ + delay);    
-    events_.emplace_back(evt);
+    auto evt = new SimCallEvent<Pkt>(callback, pkt, cycles_ + delay);
+    this->push_event(evt);
   }
 
   void reset() {
@@ -337,20 +483,14 @@ public:
 
   void tick() {
     // evaluate events
-    auto evt_it = events_.begin();
-    auto evt_it_end = events_.end();
-    while (evt_it != evt_it_end) {
-      auto& event = *evt_it;
-      if (cycles_ >= event->cycles()) {        
-        event->fire();
-        evt_it = events_.erase(evt_it);
-      } else {        
-        ++evt_it;
-      }
-    }
+    events_.fire(cycles_);
     // evaluate components
-    for (auto& object : objects_) {
-      object->do_tick();
+    if (workers_) {
+      this->tick_parallel();
+    } else {
+      for (auto& object : objects_) {
+        object->do_tick();
+      }
     }
     // advance clock    
     ++cycles_;
@@ -362,13 +502,27 @@ public:
 
 private:
 
-  SimPlatform() : cycles_(0) {}
+  struct partition_t {
+    std::vector<SimObjectBase*> objects;
+    std::vector<SimEventBase*>  events;
+  };
+
+  // consecutive objects sharing the serial partition form a serial stage,
+  // consecutive partitioned objects form a parallel stage.
+  struct stage_t {
+    bool parallel;
+    std::vector<partition_t> partitions;
+  };
+
+  SimPlatform() : partition_(0), cycles_(0), current_stage_(nullptr) {}
 
   virtual ~SimPlatform() {
     this->clear();
   }
 
   void clear() {
+    workers_.reset();
+    stages_.clear();
     objects_.clear();
     events_.clear();
   }
@@ -376,13 +530,81 @@ private:
   template <typename Pkt>
   void schedule(const SimPort<Pkt>* port, const Pkt& pkt, uint64_t delay) {
     assert(delay != 0);
-    auto evt = SimEventBase::Ptr(new SimPortEvent<Pkt>(port, pkt, cycles_ + delay));
-    events_.emplace_back(evt);
+    auto evt = new SimPortEvent<Pkt>(port, pkt, cycles_ + delay);
+    this->push_event(evt);
+  }
+
+  static std::vector<SimEventBase*>*& local_events() {
+    static thread_local std::vector<SimEventBase*>* events = nullptr;
+    return events;
+  }
+
+  void push_event(SimEventBase* evt) {
+    auto pending = local_events();
+    if (pending) {
+      pending->push_back(evt);
+    } else {
+      events_.push(evt, cycles_);
+    }
+  }
+
+  void build_stages() {
+    uint32_t last_partition = 0;
+    for (auto& object : objects_) {
+      auto partition = object->partition_;
+      bool parallel = (partition != 0);
+      if (stages_.empty() || stages_.back().parallel != parallel) {
+        stages_.push_back({parallel, {}});
+        last_partition = 0;
+      }
+      auto& stage = stages_.back();
+      if (stage.partitions.empty() || partition != last_partition) {
+        stage.partitions.push_back({});
+        last_partition = partition;
+      }
+      stage.partitions.back().objects.push_back(object.get());
+    }
+    tick_task_ = [&](uint32_t index) {
+      auto& partition = current_stage_->partitions.at(index);
+      local_events() = &partition.events;
+      for (auto object : partition.objects) {
+        object->do_tick();
+      }
+      local_events() = nullptr;
+    };
+  }
+
+  void tick_parallel() {
+    if (stages_.empty()) {
+      this->build_stages();
+    }
+    for (auto& stage : stages_) {
+      if (!stage.parallel) {
+        for (auto object : stage.partitions.at(0).objects) {
+          object->do_tick();
+        }
+        continue;
+      }
+      current_stage_ = &stage;
+      workers_->run(stage.partitions.size(), tick_task_);
+      // merge buffered events in object creation order
+      for (auto& partition : stage.partitions) {
+        for (auto evt : partition.events) {
+          events_.push(evt, cycles_);
+        }
+        partition.events.clear();
+      }
+    }
   }
 
   std::list<SimObjectBase::Ptr> objects_;
-  std::list<SimEventBase::Ptr> events_;
+  SimEventQueue events_;
+  uint32_t partition_;
   uint64_t cycles_;
+  std::unique_ptr<ThreadPool> workers_;
+  std::vector<stage_t> stages_;
+  stage_t* current_stage_;
+  ThreadPool::Task tick_task_;
 
   template <typename U> friend class SimPort;
   friend class SimObjectBase;
@@ -391,7 +613,8 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 inline SimObjectBase::SimObjectBase(const SimContext&, const char* name) 
-  : name_(name) 
+  : name_(name)
+  , partition_(0)
 {}
 
 template <typename Impl>
@@ -0,0 +1,123 @@
+// Copyright © 2019-2023
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <stdint.h>
+#include <assert.h>
+
+// Fork-join pool tuned for short, frequent parallel sections (one per
+// simulated cycle). Workers spin briefly on a new section before falling
+// back to sleeping, and the calling thread takes part in the work.
+class ThreadPool {
+public:
+  typedef std::function<void (uint32_t)> Task;
+
+  ThreadPool(uint32_t num_threads)
+    : task_(nullptr)
+    , work_(0)
+    , pending_(0)
+    , stop_(false) {
+    for (uint32_t i = 1; i < num_threads; ++i) {
+      threads_.emplace_back([this]{ this->worker_loop(); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  uint32_t size() const {
+    return threads_.size() + 1;
+  }
+
+  // run task(i) for i in [0, count) and wait for completion
+  void run(uint32_t count, const Task& task) {
+    if (count == 0)
+      return;
+    assert(count <= 0xffff);
+    task_ = &task;
+    pending_.store(count, std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      uint64_t epoch = (work_.load(std::memory_order_relaxed) >> 32) + 1;
+      work_.store((epoch << 32) | (uint64_t(count) << 16), std::memory_order_release);
+    }
+    cv_.notify_all();
+    this->execute(work_.load(std::memory_order_relaxed) >> 32);
+    while (pending_.load(std::memory_order_acquire) != 0) {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+
+  static constexpr uint32_t SPIN_COUNT = 1 << 14;
+
+  // work_ packs {epoch:32, count:16, next:16} so that a task index is only
+  // ever claimed against the section that published it.
+  void execute(uint64_t epoch) {
+    auto work = work_.load(std::memory_order_acquire);
+    for (;;) {
+      uint32_t next  = work & 0xffff;
+      uint32_t count = (work >> 16) & 0xffff;
+      if ((work >> 32) != epoch || next >= count)
+        break;
+      if (!work_.compare_exchange_weak(work, work + 1, std::memory_order_acq_rel))
+        continue;
+      (*task_)(next);
+      pending_.fetch_sub(1, std::memory_order_acq_rel);
+      work = work_.load(std::memory_order_acquire);
+    }
+  }
+
+  void worker_loop() {
+    uint64_t seen = 0;
+    for (;;) {
+      uint32_t spins = 0;
+      while ((work_.load(std::memory_order_acquire) >> 32) == seen && !stop_) {
+        if (++spins < SPIN_COUNT) {
+          std::this_thread::yield();
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&]{ return stop_ || (work_.load(std::memory_order_acquire) >> 32) != seen; });
+      }
+      if (stop_)
+        break;
+      seen = work_.load(std::memory_order_acquire) >> 32;
+      this->execute(seen);
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::mutex  mutex_;
+  std::condition_variable cv_;
+  const Task* task_;
+  std::atomic<uint64_t> work_;
+  std::atomic<uint32_t> pending_;
+  std::atomic<bool> stop_;
+};
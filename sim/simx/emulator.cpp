@@ -86,6 +86,8 @@ Emulator::Emulator(const Arch &arch, const DCRS &dcrs, Core* core)
     , core_(core)
     , warps_(arch.num_warps(), arch)
     , barriers_(arch.num_barriers(), 0)
+    , ram_(nullptr)
+    , decode_cache_(1 << DECODE_CACHE_BITS, decode_entry_t{0, 0, 0, nullptr, {}})
     , raster_units_(core->raster_units())
     , tex_units_(core->tex_units())
     , om_units_(core->om_units())
@@ -154,6 +156,70 @@ void Emulator::attach_ram(RAM* ram) {
 #else
   mmu_.attach(*ram, 0, 0xFFFFFFFF);
 #endif
+  ram_ = ram;
+}
+
+const Emulator::decode_entry_t& Emulator::fetch_decoded(uint64_t PC) {
+  // entries filled under an older code version are stale,
+  // the RAM bumps its version whenever a code page is written.
+  auto& entry = decode_cache_.at((PC >> 2) & ((1 << DECODE_CACHE_BITS) - 1));
+  if (entry.version == ram_->code_version() && entry.PC == PC) {
+    ++perf_stats_.decode_hits;
+    return entry;
+  }
+  this->translate_block(PC);
+  ++perf_stats_.decode_misses;
+  return entry;
+}
+
+void Emulator::translate_block(uint64_t PC) {
+  auto fill = [&](uint64_t pc, uint32_t code, const std::shared_ptr<Instr>& instr)->const decode_entry_t& {
+    ram_->mark_code(pc);
+    auto& entry = decode_cache_.at((pc >> 2) & ((1 << DECODE_CACHE_BITS) - 1));
+    entry.PC      = pc;
+    entry.version = ram_->code_version();
+    entry.code    = code;
+    entry.instr   = instr;
+    this->translate(*instr, pc, &entry.uop);
+    return entry;
+  };
+
+  // Fetch
+  uint32_t instr_code = 0;
+  this->icache_read(&instr_code, PC, sizeof(uint32_t));
+
+  // Decode
+  auto instr = this->decode(instr_code);
+  if (!instr) {
+    std::cout << "Error: invalid instruction 0x" << std::hex << instr_code << ", at PC=0x" << PC << std::dec << std::endl;
+    std::abort();
+  }
+
+  if (!fill(PC, instr_code, instr).uop.handler)
+    return;
+
+  // pre-translate the straight-line ALU sequence that follows,
+  // stopping ahead of branches, memory, SFU or fence instructions.
+  for (uint32_t i = 1; i < DECODE_BLOCK_SIZE; ++i) {
+    uint64_t next_pc = PC + i * 4;
+    auto& entry = decode_cache_.at((next_pc >> 2) & ((1 << DECODE_CACHE_BITS) - 1));
+    if (entry.version == ram_->code_version() && entry.PC == next_pc)
+      break;
+    uint32_t code = 0;
+    try {
+      this->icache_read(&code, next_pc, sizeof(uint32_t));
+    } catch (...) {
+      break;
+    }
+    auto op = static_cast<Opcode>(code & 0x7f);
+    if (op != Opcode::LUI && op != Opcode::AUIPC
+     && op != Opcode::R && op != Opcode::I
+     && op != Opcode::R_W && op != Opcode::I_W)
+      break;
+    auto next_instr = this->decode(code);
+    if (!next_instr || !fill(next_pc, code, next_instr).uop.handler)
+      break;
+  }
 }
 
 instr_trace_t* Emulator::step() {
@@ -201,24 +267,21 @@ instr_trace_t* Emulator::step() {
     DPN(1, warp.tmask.test(i));
   DPN(1, ", PC=0x" << std::hex << warp.PC << " (#" << std::dec << uuid << ")" << std::endl);
 
-  // Fetch
-  uint32_t instr_code = 0;
-  this->icache_read(&instr_code, warp.PC, sizeof(uint32_t));
-
-  // Decode
-  auto instr = this->decode(instr_code);
-  if (!instr) {
-    std::cout << "Error: invalid instruction 0x" << std::hex << instr_code << ", at PC=0x" << warp.PC << " (#" << std::dec << uuid << ")" << std::endl;
-    std::abort();
-  }
+  // Fetch + decode
+  auto& decoded = this->fetch_decoded(warp.PC);
+  const auto& instr = decoded.instr;
 
-  DP(1, "Instr 0x" << std::hex << instr_code << ": " << std::dec << *instr);
+  DP(1, "Instr 0x" << std::hex << decoded.code << ": " << std::dec << *instr);
 
   // Create trace
   auto trace = new instr_trace_t(uuid, arch_);
 
   // Execute
-  this->execute(*instr, scheduled_warp, trace);
+  if (decoded.uop.handler) {
+    this->execute_fast(decoded.uop, scheduled_warp, trace);
+  } else {
+    this->execute(*instr, scheduled_warp, trace);
+  }
 
   DP(5, "Register state:");
   for (uint32_t i = 0; i < MAX_NUM_REGS; ++i) {
@@ -438,6 +501,8 @@ Word Emulator::get_csr(uint32_t addr, uint32_t tid, uint32_t wid) {
         CSR_READ_64(VX_CSR_MPM_STORES, core_perf.stores);
         CSR_READ_64(VX_CSR_MPM_IFETCH_LT, core_perf.ifetch_latency);
         CSR_READ_64(VX_CSR_MPM_LOAD_LT, core_perf.load_latency);
+        CSR_READ_64(VX_CSR_MPM_DECODE_HITS, perf_stats_.decode_hits);
+        CSR_READ_64(VX_CSR_MPM_DECODE_MISSES, perf_stats_.decode_misses);
         }
       } break;
       case VX_DCR_MPM_CLASS_MEM: {
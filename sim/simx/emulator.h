@@ -33,6 +33,16 @@ class instr_trace_t;
 
 class Emulator {
 public:
+  struct PerfStats {
+    uint64_t decode_hits;
+    uint64_t decode_misses;
+
+    PerfStats()
+      : decode_hits(0)
+      , decode_misses(0)
+    {}
+  };
+
   Emulator(const Arch &arch,
            const DCRS &dcrs,
            Core* core);
@@ -57,8 +67,46 @@ public:
 
   int get_exitcode() const;
 
+  const PerfStats& perf_stats() const {
+    return perf_stats_;
+  }
+
 private:
 
+  // direct-mapped decoded instruction cache indexed by PC
+  static constexpr uint32_t DECODE_CACHE_BITS = 12;
+
+  // maximum length of a pre-translated straight-line block
+  static constexpr uint32_t DECODE_BLOCK_SIZE = 32;
+
+  typedef std::vector<std::vector<Word>> ireg_file_t;
+
+  typedef void (*uop_handler_t)(ireg_file_t& ireg_file,
+                                const ThreadMask& tmask,
+                                uint32_t rd,
+                                uint32_t rs1,
+                                uint32_t rs2,
+                                Word imm);
+
+  // pre-bound integer ALU operation with resolved operands
+  struct uop_t {
+    uop_handler_t handler;
+    AluType  alu_type;
+    uint32_t num_srcs;
+    uint32_t rd;
+    uint32_t rs1;
+    uint32_t rs2;
+    Word     imm;
+  };
+
+  struct decode_entry_t {
+    uint64_t PC;
+    uint64_t version;
+    uint32_t code;
+    std::shared_ptr<Instr> instr;
+    uop_t    uop;
+  };
+
   struct ipdom_entry_t {
     ipdom_entry_t(const ThreadMask &tmask, Word PC);
     ipdom_entry_t(const ThreadMask &tmask);
@@ -74,7 +122,7 @@ private:
 
     Word                              PC;
     ThreadMask                        tmask;
-    std::vector<std::vector<Word>>    ireg_file;
+    ireg_file_t                       ireg_file;
     std::vector<std::vector<uint64_t>> freg_file;
     std::stack<ipdom_entry_t>         ipdom_stack;
     Byte                              fcsr;
@@ -90,6 +138,14 @@ private:
 
   std::shared_ptr<Instr> decode(uint32_t code) const;
 
+  const decode_entry_t& fetch_decoded(uint64_t PC);
+
+  void translate_block(uint64_t PC);
+
+  void translate(const Instr &instr, uint64_t PC, uop_t* uop) const;
+
+  void execute_fast(const uop_t& uop, uint32_t wid, instr_trace_t *trace);
+
   void execute(const Instr &instr, uint32_t wid, instr_trace_t *trace);
 
   void icache_read(void* data, uint64_t addr, uint32_t size);
@@ -129,6 +185,8 @@ private:
   std::vector<WarpMask> barriers_;
   std::unordered_map<int, std::stringstream> print_bufs_;
   MemoryUnit  mmu_;
+  RAM*        ram_;
+  std::vector<decode_entry_t> decode_cache_;
 
   std::vector<RasterUnit::Ptr> raster_units_;
   std::vector<TexUnit::Ptr> tex_units_;
@@ -141,6 +199,8 @@ private:
   uint32_t    raster_idx_;
   uint32_t    tex_idx_;
   uint32_t    om_idx_;
+
+  PerfStats   perf_stats_;
 };
 
 }
@@ -12,6 +12,8 @@
 // limitations under the License.
 
 #include <iostream>
+#include <array>
+#include <mutex>
 #include <stdlib.h>
 #include <unistd.h>
 #include <math.h>
@@ -55,6 +57,201 @@ inline int64_t check_boxing(int64_t a) {
   return nan_box(0x7fc00000); // NaN
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SIMX_FASTPATH_DISABLE
+namespace {
+
+#define ALU_OP(name, expr) \
+  struct name { \
+    static Word eval(Word a, Word b) { \
+      __unused(a, b); \
+      return expr; \
+    } \
+  }
+
+ALU_OP(op_lui,    b);
+ALU_OP(op_add,    a + b);
+ALU_OP(op_sub,    a - b);
+ALU_OP(op_sll,    a << (b & ((Word(1) << log2up(XLEN)) - 1)));
+ALU_OP(op_slli,   a << b);
+ALU_OP(op_slt,    WordI(a) < WordI(b));
+ALU_OP(op_sltu,   a < b);
+ALU_OP(op_xor,    a ^ b);
+ALU_OP(op_srl,    a >> (b & ((Word(1) << log2up(XLEN)) - 1)));
+ALU_OP(op_srli,   a >> b);
+ALU_OP(op_sra,    WordI(a) >> (b & ((Word(1) << log2up(XLEN)) - 1)));
+ALU_OP(op_srai,   WordI(a) >> b);
+ALU_OP(op_or,     a | b);
+ALU_OP(op_and,    a & b);
+ALU_OP(op_czeqz,  (b == 0) ? 0 : a);
+ALU_OP(op_cznez,  (b != 0) ? 0 : a);
+ALU_OP(op_mul,    a * b);
+ALU_OP(op_mulh,   (DWordI(WordI(a)) * DWordI(WordI(b))) >> XLEN);
+ALU_OP(op_mulhsu, (DWordI(WordI(a)) * DWordI(DWord(b))) >> XLEN);
+ALU_OP(op_mulhu,  (DWord(a) * DWord(b)) >> XLEN);
+ALU_OP(op_div,    (b == 0) ? Word(-1) : ((WordI(a) == (WordI(1) << (XLEN-1)) && WordI(b) == -1) ? a : Word(WordI(a) / WordI(b))));
+ALU_OP(op_divu,   (b == 0) ? Word(-1) : (a / b));
+ALU_OP(op_rem,    (b == 0) ? a : ((WordI(a) == (WordI(1) << (XLEN-1)) && WordI(b) == -1) ? 0 : Word(WordI(a) % WordI(b))));
+ALU_OP(op_remu,   (b == 0) ? a : (a % b));
+#if (XLEN == 64)
+ALU_OP(op_addw,   sext(uint64_t(uint32_t(a) + uint32_t(b)), 32));
+ALU_OP(op_subw,   sext(uint64_t(uint32_t(a) - uint32_t(b)), 32));
+ALU_OP(op_sllw,   sext(uint64_t(uint32_t(a) << (b & 0x1F)), 32));
+ALU_OP(op_srlw,   sext(uint64_t(uint32_t(a) >> (b & 0x1F)), 32));
+ALU_OP(op_sraw,   sext(uint64_t(uint32_t(int32_t(a) >> (b & 0x1F))), 32));
+#endif
+
+#undef ALU_OP
+
+template <typename Op, bool use_imm>
+void alu_handler(std::vector<std::vector<Word>>& ireg_file,
+                 const ThreadMask& tmask,
+                 uint32_t rd,
+                 uint32_t rs1,
+                 uint32_t rs2,
+                 Word imm) {
+  for (uint32_t t = 0, n = ireg_file.size(); t < n; ++t) {
+    if (!tmask.test(t))
+      continue;
+    auto& regs = ireg_file[t];
+    regs[rd] = Op::eval(regs[rs1], use_imm ? imm : regs[rs2]);
+  }
+}
+
+void nop_handler(std::vector<std::vector<Word>>&, const ThreadMask&, uint32_t, uint32_t, uint32_t, Word) {}
+
+}
+#endif
+
+void Emulator::translate(const Instr &instr, uint64_t PC, uop_t* uop) const {
+  uop->handler  = nullptr;
+  uop->alu_type = AluType::ARITH;
+  uop->num_srcs = 0;
+  uop->rd       = instr.getRDest();
+  uop->rs1      = instr.getRSrc(0);
+  uop->rs2      = instr.getRSrc(1);
+  uop->imm      = sext((Word)instr.getImm(), 32);
+
+#ifndef SIMX_FASTPATH_DISABLE
+  auto func3 = instr.getFunc3();
+  auto func7 = instr.getFunc7();
+
+  switch (instr.getOpcode()) {
+  case Opcode::LUI:
+    uop->handler = alu_handler<op_lui, true>;
+    break;
+  case Opcode::AUIPC:
+    uop->imm += PC;
+    uop->handler = alu_handler<op_lui, true>;
+    break;
+  case Opcode::R:
+    uop->num_srcs = 2;
+    if (func7 == 0x7) {
+      switch (func3) {
+      case 5: uop->handler = alu_handler<op_czeqz, false>; break;
+      case 7: uop->handler = alu_handler<op_cznez, false>; break;
+      default: break;
+      }
+    } else if (func7 & 0x1) {
+      uop->alu_type = (func3 < 4) ? AluType::IMUL : AluType::IDIV;
+      switch (func3) {
+      case 0: uop->handler = alu_handler<op_mul, false>; break;
+      case 1: uop->handler = alu_handler<op_mulh, false>; break;
+      case 2: uop->handler = alu_handler<op_mulhsu, false>; break;
+      case 3: uop->handler = alu_handler<op_mulhu, false>; break;
+      case 4: uop->handler = alu_handler<op_div, false>; break;
+      case 5: uop->handler = alu_handler<op_divu, false>; break;
+      case 6: uop->handler = alu_handler<op_rem, false>; break;
+      case 7: uop->handler = alu_handler<op_remu, false>; break;
+      }
+    } else {
+      switch (func3) {
+      case 0: uop->handler = (func7 & 0x20) ? alu_handler<op_sub, false> : alu_handler<op_add, false>; break;
+      case 1: uop->handler = alu_handler<op_sll, false>; break;
+      case 2: uop->handler = alu_handler<op_slt, false>; break;
+      case 3: uop->handler = alu_handler<op_sltu, false>; break;
+      case 4: uop->handler = alu_handler<op_xor, false>; break;
+      case 5: uop->handler = (func7 & 0x20) ? alu_handler<op_sra, false> : alu_handler<op_srl, false>; break;
+      case 6: uop->handler = alu_handler<op_or, false>; break;
+      case 7: uop->handler = alu_handler<op_and, false>; break;
+      }
+    }
+    break;
+  case Opcode::I:
+    uop->num_srcs = 1;
+    switch (func3) {
+    case 0: uop->handler = alu_handler<op_add, true>; break;
+    case 1: uop->handler = alu_handler<op_slli, true>; break;
+    case 2: uop->handler = alu_handler<op_slt, true>; break;
+    case 3: uop->handler = alu_handler<op_sltu, true>; break;
+    case 4: uop->handler = alu_handler<op_xor, true>; break;
+    case 5: uop->handler = (func7 & 0x20) ? alu_handler<op_srai, true> : alu_handler<op_srli, true>; break;
+    case 6: uop->handler = alu_handler<op_or, true>; break;
+    case 7: uop->handler = alu_handler<op_and, true>; break;
+    }
+    break;
+#if (XLEN == 64)
+  case Opcode::R_W:
+    uop->num_srcs = 2;
+    if (func7 & 0x1)
+      break; // RV64M word ops use the interpreter
+    switch (func3) {
+    case 0: uop->handler = (func7 & 0x20) ? alu_handler<op_subw, false> : alu_handler<op_addw, false>; break;
+    case 1: uop->handler = alu_handler<op_sllw, false>; break;
+    case 5: uop->handler = (func7 & 0x20) ? alu_handler<op_sraw, false> : alu_handler<op_srlw, false>; break;
+    default: break;
+    }
+    break;
+  case Opcode::I_W:
+    uop->num_srcs = 1;
+    switch (func3) {
+    case 0: uop->handler = alu_handler<op_addw, true>; break;
+    case 1: uop->handler = alu_handler<op_sllw, true>; break;
+    case 5: uop->handler = (func7 & 0x20) ? alu_handler<op_sraw, true> : alu_handler<op_srlw, true>; break;
+    default: break;
+    }
+    break;
+#endif
+  default:
+    break;
+  }
+
+  // writes to x0 are discarded
+  if (uop->handler && uop->rd == 0) {
+    uop->handler = nop_handler;
+  }
+#else
+  __unused(instr, PC);
+#endif
+}
+
+void Emulator::execute_fast(const uop_t& uop, uint32_t wid, instr_trace_t *trace) {
+  auto& warp = warps_.at(wid);
+  assert(warp.tmask.any());
+
+  trace->cid      = core_->id();
+  trace->wid      = wid;
+  trace->PC       = warp.PC;
+  trace->tmask    = warp.tmask;
+  trace->fu_type  = FUType::ALU;
+  trace->alu_type = uop.alu_type;
+  trace->dst_reg  = {RegType::Integer, uop.rd};
+  trace->wb       = (uop.rd != 0);
+  if (uop.num_srcs > 0) {
+    trace->src_regs[0] = {RegType::Integer, uop.rs1};
+  }
+  if (uop.num_srcs > 1) {
+    trace->src_regs[1] = {RegType::Integer, uop.rs2};
+  }
+
+  uop.handler(warp.ireg_file, warp.tmask, uop.rd, uop.rs1, uop.rs2, uop.imm);
+
+  warp.PC += 4;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
   auto& warp = warps_.at(wid);
   assert(warp.tmask.any());
@@ -93,8 +290,8 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
         break;
   }
 
-  std::vector<reg_data_t[3]> rsdata(num_threads);
-  std::vector<reg_data_t> rddata(num_threads);
+  std::array<reg_data_t[3], MAX_NUM_THREADS> rsdata;
+  std::array<reg_data_t, MAX_NUM_THREADS> rddata;
 
   auto num_rsrcs = instr.getNRSrc();
   if (num_rsrcs) {
@@ -754,6 +951,8 @@ void Emulator::execute(const Instr &instr, uint32_t wid, instr_trace_t *trace) {
     auto amo_type = func7 >> 2;
     uint32_t data_bytes = 1 << (func3 & 0x3);
     uint32_t data_width = 8 * data_bytes;
+    // keep read-modify-write atomic w.r.t. cores ticked on other host threads
+    std::lock_guard<RAM> ram_lock(*ram_);
     for (uint32_t t = thread_start; t < num_threads; ++t) {
       if (!warp.tmask.test(t))
         continue;
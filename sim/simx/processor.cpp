@@ -11,6 +11,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdlib.h>
+#include <algorithm>
 #include "processor.h"
 #include "processor_impl.h"
 
@@ -52,12 +54,22 @@ ProcessorImpl::ProcessorImpl(const Arch& arch)
 
   // create clusters
   for (uint32_t i = 0; i < arch.num_clusters(); ++i) {
+    // each cluster is a separate partition for parallel ticking
+    SimPlatform::instance().set_partition(i + 1);
     clusters_.at(i) = Cluster::Create(i, this, arch, dcrs_);
+    SimPlatform::instance().set_partition(0);
     // connect L3 core ports
     clusters_.at(i)->mem_req_port.bind(&l3cache_->CoreReqPorts.at(i));
     l3cache_->CoreRspPorts.at(i).bind(&clusters_.at(i)->mem_rsp_port);
   }
 
+  // enable parallel ticking of clusters
+  auto num_threads_s = getenv("VORTEX_SIMX_THREADS");
+  if (num_threads_s) {
+    uint32_t num_threads = std::min<uint32_t>(atoi(num_threads_s), arch.num_clusters());
+    SimPlatform::instance().set_num_threads(num_threads);
+  }
+
   // set up memory profiling
   memsim_->MemReqPort.tx_callback([&](const MemReq& req, uint64_t cycle){
     __unused (cycle);